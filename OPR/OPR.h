@@ -14,6 +14,34 @@
 #include <limits.h>
 #include <sstream>
 #include <iterator>
+#include <unordered_map>
+#include <unordered_set>
+#include <queue>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <condition_variable>
+#include <stdint.h>
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+#ifdef _WIN32
+	#define WIN32_LEAN_AND_MEAN
+	#define NOMINMAX
+	#include <windows.h>
+#else
+	#include <fcntl.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <unistd.h>
+#endif
 
 using namespace tinyxml2;
 using namespace std;
@@ -23,24 +51,519 @@ using namespace std;
 #endif
 #define POOL_SIZE_TRANSFER		10
 #define POOL_SIZE_SWAP			10
-#define TRANSFER_TABU_LIST_SIZE 8
-#define SWAP_TABU_LIST_SIZE		8
+#define TRANSFER_TOP_K			1
+#define GRANULAR_NEIGHBORS		25
+#define GRANULAR_SEARCH			1
+#define SEARCH_THREADS			0
+#define SEARCH_PROFILE			0
+#define NUMBER_OF_STARTS		5
+#define START_THREADS			0
+#define ITERATION_BUDGET		0
+#define ISLAND_MODEL			0
+#define MIGRATION_INTERVAL		200
+#define MIGRATION_PERIOD_MS		500
+#define MIGRATION_TOPOLOGY		RING_TOPOLOGY
+#define MIGRATION_REPLACEMENT	REPLACE_IF_BETTER_THAN_CURRENT
+#define TABU_TENURE				0
 #define MAX_IT_TRANSFER			5
 #define MAX_IT_SWAP				5
-#define MAX_IT_INTRA			10
+#define INTRA_NEIGHBORS			8
+#define OR_OPT_MAX_SEGMENT		3
+#define HELD_KARP_MAX_LENGTH	12
 #define MAX_IT_SA				5
+#define MIN_PATH_CACHE_VERSION	4
+#define MIN_PATH_THREADS		0
+#define MIN_PATH_PACKED			0
+#define MIN_PATH_MAX			UINT16_MAX
+#define XML_PULL_BUFFER_SIZE	65536
+
+/*
+* Index of the minimum paths file :
+*		every (SrtpCode, Deck) pair is interned into a room id
+*		every unordered pair of room ids is mapped to its travel time
+*		every ordered pair of room ids is mapped to its extended path (first arc, number of arcs),
+*		arcs holding (room1, room2, travel time) for every arc
+*/
+struct MinPathIndex {
+	unordered_map<string, int> roomIds;
+	vector<string> roomSrtpCodes;
+	vector<string> roomDecks;
+	unordered_map<unsigned long long, int> travelTime;
+	unordered_map<unsigned long long, pair<int, int>> extendedPaths;
+	vector<int32_t> arcs;
+};
+
+/*
+* Tokens returned by the streaming XML reader
+*/
+enum XMLPullToken { XML_PULL_START, XML_PULL_END, XML_PULL_TEXT, XML_PULL_EOF };
+
+/*
+* Streaming XML reader : the file is read by chunks of XML_PULL_BUFFER_SIZE bytes
+* and returned token by token, no tree is ever built
+*/
+struct XMLPullParser {
+	ifstream file;
+	vector<char> buffer;
+	size_t position = 0;
+	size_t length = 0;
+	bool pendingEnd = false;
+	string pendingName;
+};
+
+/*
+* Matrix of minimum paths between the Manual Actions
+*		Manual Actions located in the same room (same SrtpCode and Deck) share the same room id,
+*		so the minimum paths are only stored between the distinct rooms :
+*		minPath(i, j) = room(MARoom[i], MARoom[j])
+*		The starting rooms are depot nodes following the Manual Actions : node numberOfMA + s is the starting room s,
+*		so that a route starting with its depot node is evaluated without any special case
+*		The distances are uint16 (saturated at MIN_PATH_MAX) stored in one 64 bytes aligned block, either as the full
+*		rooms x rooms matrix or, if packed, as its upper triangle (diagonal included) : rowOffset[r] + c is the slot of (r, c), r <= c
+*		roomMinPath either points to a buffer owned by storage or directly inside a memory mapped cache file
+*/
+struct MinPathMatrix {
+	vector<int> MARoom;
+	int numberOfMA = 0;
+	int rooms = 0;
+	bool packed = false;
+	vector<size_t> rowOffset;
+	const uint16_t *roomMinPath = nullptr;
+	shared_ptr<const void> storage;
+
+	size_t slot(int room1, int room2) const {
+		if (packed && room1 > room2) {
+			swap(room1, room2);
+		}
+		return rowOffset[room1] + room2;
+	}
+	int room(int room1, int room2) const {
+		return roomMinPath[slot(room1, room2)];
+	}
+	int operator()(int MA1, int MA2) const {
+		return room(MARoom[MA1], MARoom[MA2]);
+	}
+	size_t size() const {
+		return packed ? (size_t)rooms * (rooms + 1) / 2 : (size_t)rooms * rooms;
+	}
+};
+
+/*
+* Graph of the rooms of the ship, built from GraphArc elements (Room1, Room2, TravelTime)
+*		every (SrtpCode, Deck) pair is interned into a room id
+*		the arcs are undirected and stored in compressed rows :
+*		the neighbours of room r are arcTarget[arcStart[r]] .. arcTarget[arcStart[r + 1] - 1]
+*/
+struct RoomGraph {
+	unordered_map<string, int> roomIds;
+	vector<string> roomSrtpCodes;
+	vector<string> roomDecks;
+	vector<int> arcStart;
+	vector<int> arcTarget;
+	vector<int> arcTime;
+};
+
+/*
+* Shortest paths computed on the room graph from a set of source rooms
+*		distance[s * rooms + r] = minimum time between sourceRooms[s] and room r (-1 if r cannot be reached)
+*		predecessor[s * rooms + r] = room preceding r on this shortest path (-1 for the source and unreachable rooms)
+*/
+struct RoomShortestPaths {
+	int rooms = 0;
+	vector<int> sourceRooms;
+	vector<int32_t> distance;
+	vector<int32_t> predecessor;
+};
+
+/*
+* Collects the GraphArc elements of a document, without looking inside them
+*/
+struct GraphArcCollector : public XMLVisitor {
+	vector<const XMLElement*> arcs;
+
+	virtual bool VisitEnter(const XMLElement &element, const XMLAttribute *) {
+		if (strcmp(element.Name(), "GraphArc") == 0) {
+			arcs.push_back(&element);
+			return false;
+		}
+		return true;
+	}
+};
+
+/*
+* Read-only memory mapping of a whole file
+*/
+struct MappedFile {
+	const char *data = nullptr;
+	size_t size = 0;
+#ifdef _WIN32
+	HANDLE file = INVALID_HANDLE_VALUE;
+	HANDLE mapping = NULL;
+#else
+	int file = -1;
+#endif
+	~MappedFile();
+};
+
+/*
+* Header of the binary cache of the minimum path matrix (MinimumPaths/minPathMatrix_X.bin)
+*		The header is followed by the distances of elementSize bytes each, row by row :
+*		rooms x rooms of them, or only the upper triangle if packed is set
+*		The header is 64 bytes long so that the distances are aligned on a cache line
+*/
+struct MinPathCacheHeader {
+	char magic[8];
+	uint32_t version;
+	uint32_t elementSize;
+	uint32_t rooms;
+	uint32_t numberOfMA;
+	uint64_t inputHash;
+	uint64_t checksum;
+	uint32_t numberOfStart;
+	uint32_t packed;
+	uint32_t standalone;
+	uint8_t reserved[12];
+};
+
+/*
+* Eligibility of the Operators, stored as bitsets of 64 bits words :
+*		operatorMask[i * operatorWords + j / 64] has the bit j % 64 set if Operator j has the required skill for the Manual Action i
+*		actionMask[j * actionWords + i / 64] has the bit i % 64 set if Manual Action i can be done by Operator j
+*		operatorCount[i] is the number of Operators skilled for the Manual Action i
+*		The SystemCodes are interned : systemCodeOfMA[i] is the id of the SystemCode required by the Manual Action i
+*/
+struct Eligibility {
+	int numberOfMA = 0;
+	int numberOfOperator = 0;
+	int operatorWords = 0;
+	int actionWords = 0;
+	vector<uint64_t> operatorMask;
+	vector<uint64_t> actionMask;
+	vector<int> operatorCount;
+	unordered_map<string, int> systemCodeIds;
+	vector<int> systemCodeOfMA;
+	bool operator()(int MA, int OP) const {
+		return (operatorMask[MA * operatorWords + (OP >> 6)] >> (OP & 63)) & 1;
+	}
+	const uint64_t *operatorsOf(int MA) const {
+		return &operatorMask[MA * operatorWords];
+	}
+	const uint64_t *actionsOf(int OP) const {
+		return &actionMask[OP * actionWords];
+	}
+};
+
+/*
+* Granular neighborhoods : the nearest Manual Actions of every Manual Action in the minimum path matrix
+*		nearest(MA) holds the GRANULAR_NEIGHBORS nearest other Manual Actions, plus the ones tied with the last of them
+*		(so that the Manual Actions of a same room are never split), closest first, in compressed rows from start
+*		nearestFor(MA, OP) is built the same way among the Manual Actions that the Operator OP can perform
+*/
+struct NeighborLists {
+	int numberOfOperator = 0;
+	vector<int> start;
+	vector<int> actions;
+	vector<int> operatorRows;
+	vector<int> operatorActions;
+	const int *nearest(int MA) const {
+		return &actions[start[MA]];
+	}
+	int nearestCount(int MA) const {
+		return start[MA + 1] - start[MA];
+	}
+	const int *nearestFor(int MA, int OP) const {
+		return &operatorActions[operatorRows[MA * numberOfOperator + OP]];
+	}
+	int nearestForCount(int MA, int OP) const {
+		return operatorRows[MA * numberOfOperator + OP + 1] - operatorRows[MA * numberOfOperator + OP];
+	}
+};
+
+/*
+* Data of the problem shared by every search : the minimum paths, the service times, the eligibility,
+* the depot node of every Operator and the granular neighborhoods
+*		It is built once and never modified, so that it is passed by (const) reference and can serve
+*		several searches at once
+*/
+struct ProblemInstance {
+	MinPathMatrix minPath;
+	vector<int> serviceTime;
+	Eligibility eligibility;
+	vector<int> operatorStart;
+	NeighborLists neighbors;
+};
+
+/*
+* Routes of a solution, stored in flat arrays indexed by node :
+*		nodes 0 .. numberOfMA - 1 are the Manual Actions, node numberOfMA + r is the head of route r (Operator r)
+*		every route is a circular doubly linked list through next / prev, starting and ending at its head
+*		routeOf / positionOf give the route of a node and its position in it (0 for the head, 1 for the first Manual Action)
+*		routeLength / routeCost are the number of Manual Actions and the cost of every route,
+*		makespan / makespanRoute the cost and the index of the route with the highest cost
+*		forwardTravel / backwardTravel are the prefix sums of the travel times along the route up to every node,
+*		going forward and going backward (eg. from the node to its predecessor), they are refreshed by updateRouteCost
+*		costTree is a tournament tree over the routes : the leaves (from costLeaves) hold the routes, every internal node
+*		the route with the highest cost of its subtree (-1 for the padding), so that changing a route cost takes O(log M)
+*		secondMakespan is the highest cost among the other routes than makespanRoute
+*		routeMembers holds for every route the bitset (actionWords words) of its Manual Actions, kept along routeOf
+*/
+struct SolutionData {
+	int numberOfMA = 0;
+	vector<int> routeOf;
+	vector<int> positionOf;
+	vector<int> next;
+	vector<int> prev;
+	vector<int> forwardTravel;
+	vector<int> backwardTravel;
+	vector<int> routeLength;
+	vector<int> routeCost;
+	int costLeaves = 0;
+	vector<int> costTree;
+	int makespan = 0;
+	int makespanRoute = 0;
+	int secondMakespan = 0;
+	int actionWords = 0;
+	vector<uint64_t> routeMembers;
+
+	int routeHead(int route) const {
+		return numberOfMA + route;
+	}
+	const uint64_t* membersOf(int route) const {
+		return &routeMembers[(size_t)route * actionWords];
+	}
+	void setMember(int route, int action, bool member) {
+		uint64_t &word = routeMembers[(size_t)route * actionWords + (action >> 6)];
+		word = member ? word | (1ULL << (action & 63)) : word & ~(1ULL << (action & 63));
+	}
+};
+
+/*
+* Copy-on-write handle of a SolutionData : copying a Solution (eg. into a pool) only shares the data,
+* which is duplicated by modify() the first time a shared solution is changed
+*/
+struct Solution {
+	shared_ptr<SolutionData> data;
+
+	const SolutionData* operator->() const {
+		return data.get();
+	}
+	const SolutionData& operator*() const {
+		return *data;
+	}
+	SolutionData& modify() {
+		if (data.use_count() > 1) {
+			data = make_shared<SolutionData>(*data);
+		}
+		return *data;
+	}
+};
+
+/*
+* Kinds of moves between two routes
+*		TRANSFER_MOVE : action1 leaves route1 for route2
+*		SWAP_MOVE : action1 of route1 and action2 of route2 go in the route of the other one
+*/
+enum MoveType { TRANSFER_MOVE, SWAP_MOVE };
+
+/*
+* Compact description of a move, scored without building the solution it leads to
+*		position1 / position2 are the positions of action1 / action2 before the move (where action1 arrives for a transfer),
+*		after1 / after2 the nodes after which the Manual Action arriving in route1 / route2 is inserted,
+*		delta1 / delta2 the cost changes of route1 / route2 and makespan the makespan once the move is applied
+*/
+struct Move {
+	MoveType type = TRANSFER_MOVE;
+	int action1 = -1;
+	int action2 = -1;
+	int route1 = -1;
+	int route2 = -1;
+	int position1 = 0;
+	int position2 = 0;
+	int after1 = -1;
+	int after2 = -1;
+	int delta1 = 0;
+	int delta2 = 0;
+	int makespan = 0;
+};
+/*
+* Custom compare for the moves of the heuristics : the lowest makespan first, then the lowest total cost change
+*/
+bool compareMove(const Move &move1, const Move &move2);
+
+/*
+* Random number stream (xoshiro256**) of a search, so that the searches and their workers never share a state
+*		seed fills the state with splitmix64, so that close seeds (eg. drawn one after the other from a parent stream) give independent streams
+*		below draws uniformly in [0, bound[ (bound > 0) without bias and almost always without division (Lemire's method)
+*		unit draws uniformly in [0, 1[
+*/
+struct RandomStream {
+	uint64_t state[4];
+	void seed(uint64_t seed) {
+		for (int i = 0; i < 4; i++) {
+			uint64_t z = (seed += 0x9E3779B97F4A7C15ULL);
+			z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+			z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+			state[i] = z ^ (z >> 31);
+		}
+	}
+	uint64_t next() {
+		uint64_t result = rotateLeft64(state[1] * 5, 7) * 9, t = state[1] << 17;
+		state[2] ^= state[0];
+		state[3] ^= state[1];
+		state[1] ^= state[2];
+		state[0] ^= state[3];
+		state[2] ^= t;
+		state[3] = rotateLeft64(state[3], 45);
+		return result;
+	}
+	int below(int bound) {
+		assert(bound > 0);
+		uint64_t product = (next() >> 32) * (uint64_t)bound;
+		if ((uint32_t)product < (uint32_t)bound) {
+			uint32_t threshold = (0U - (uint32_t)bound) % (uint32_t)bound;
+			while ((uint32_t)product < threshold) {
+				product = (next() >> 32) * (uint64_t)bound;
+			}
+		}
+		return (int)(product >> 32);
+	}
+	double unit() {
+		return (next() >> 11) * (1.0 / 9007199254740992.0);
+	}
+	static uint64_t rotateLeft64(uint64_t x, int k) {
+		return (x << k) | (x >> (64 - k));
+	}
+};
+
+/*
+* Buffers of the exact sequencing of a route (sequenceRouteExactly), reused from one route to the next
+*		path is the table of the dynamic programming, up to 2^HELD_KARP_MAX_LENGTH x HELD_KARP_MAX_LENGTH entries
+*/
+struct SequencingBuffers {
+	vector<pair<int, int>> actions;
+	vector<int> roomOf;
+	vector<int> groupStart;
+	vector<int> travel;
+	vector<int> path;
+	vector<int> order;
+	vector<int> current;
+	vector<int> routeActions;
+};
+
+/*
+* State of a search worker : its random stream and the buffers reused from one candidate to the next
+*		sequencing is used by the worker that applies the moves
+*/
+struct SearchWorker {
+	RandomStream random;
+	vector<Move> moves;
+	vector<int> candidates;
+	vector<uint64_t> actionBits;
+	SequencingBuffers sequencing;
+};
+
+/*
+* Persistent pool of threads running the same job on every worker, the calling thread being worker 0
+*		generation counts the jobs given to the threads, pending the threads which have not finished the current one
+*		The threads are stopped and joined when the pool is destroyed
+*/
+struct WorkerPool {
+	vector<thread> threads;
+	mutex lock;
+	condition_variable wake;
+	condition_variable done;
+	function<void(int)> job;
+	int generation = 0;
+	int pending = 0;
+	bool stopping = false;
+
+	~WorkerPool();
+};
+
+/*
+* Islands from which an island takes its immigrants
+*		RING_TOPOLOGY : the island before it (the islands form a ring)
+*		BROADCAST_TOPOLOGY : every other island, the best immigrant being kept
+*/
+enum MigrationTopology { RING_TOPOLOGY, BROADCAST_TOPOLOGY };
+
+/*
+* Solution of an island replaced by an immigrant
+*		REPLACE_IF_BETTER_THAN_CURRENT : the current solution of the tabu search, if the immigrant is better than it
+*		REPLACE_IF_BETTER_THAN_BEST : the current solution, if the immigrant is better than the best one of the island
+*		REPLACE_ALWAYS : the current solution, whatever the immigrant
+*/
+enum ReplacementPolicy { REPLACE_IF_BETTER_THAN_CURRENT, REPLACE_IF_BETTER_THAN_BEST, REPLACE_ALWAYS };
+
+/*
+* Mailbox in which an island publishes its best solution, as the successor (next) of every node
+*		It is a sequence lock without any lock : version is odd while the island writes it, a reader copies the nodes and
+*		gives up if version has changed meanwhile, so that an island never waits for another one
+*		version 0 means that nothing has been published yet
+*/
+struct Mailbox {
+	atomic<unsigned int> version{ 0 };
+	atomic<int> makespan{ INT_MAX };
+	unique_ptr<atomic<int>[]> next;
+};
+
+/*
+* Barrier on which the islands of a deterministic run (ITERATION_BUDGET set) meet at every migration,
+* so that every island reads what the others published at the same iteration
+*		generation counts the times the islands have all met
+*/
+struct MigrationBarrier {
+	mutex lock;
+	condition_variable met;
+	int islands = 0;
+	int waiting = 0;
+	int generation = 0;
+};
 
-typedef tuple<vector<pair<vector<int>, int>>, pair<int, int>, int> transferSolutionTuple;
 /*
-* Custom compare for transfer heuristic
+* Place of a tabu search in the island model
+*		mailboxes are shared by every island, the one of the island being mailboxes[index]
+*		received holds for every island the version of the last immigrant taken from it, published the makespan last published
+*		iterations and lastMigration are the iterations and the time since the last migration, next holds the best immigrant
+*		barrier is the barrier of a deterministic run (NULL otherwise)
 */
-bool compareTransferSolution(transferSolutionTuple &sol1, transferSolutionTuple &sol2);
+struct Island {
+	int index = 0;
+	vector<Mailbox> *mailboxes = NULL;
+	MigrationBarrier *barrier = NULL;
+	vector<unsigned int> received;
+	int published = INT_MAX;
+	int iterations = 0;
+	chrono::steady_clock::time_point lastMigration;
+	vector<int> next;
+};
 
-typedef tuple<vector<pair<vector<int>, int>>, pair<pair<int, int>, pair<int, int>>, int> swapSolutionTuple;
 /*
-* Custom compare for swap heuristic
+* Result of one start of the multi-start search : the seed of its random stream, its running time (seconds) and its best solution
 */
-bool compareSwapSolution(swapSolutionTuple &sol1, swapSolutionTuple &sol2);
+struct StartResult {
+	uint64_t seed = 0;
+	float time = 0;
+	Solution solution;
+};
+
+/*
+* Tabu memory of the tabu search, one attribute per (Manual Action, Operator) :
+*		tabuUntil[MA * numberOfOperator + OP] is the iteration (accepted move) until which taking MA out of the route of OP is tabu
+*		tenure is the number of iterations an attribute stays tabu
+*/
+struct TabuMemory {
+	int numberOfOperator = 0;
+	int iteration = 0;
+	int tenure = 0;
+	vector<int> tabuUntil;
+	bool isTabu(int MA, int OP) const {
+		return tabuUntil[MA * numberOfOperator + OP] > iteration;
+	}
+	void makeTabu(int MA, int OP) {
+		tabuUntil[MA * numberOfOperator + OP] = iteration + tenure;
+	}
+};
 
 /*
 * Prints the content of a matrix
@@ -49,97 +572,554 @@ void printMatrix(vector<vector<int>> matrix);
 /*
 * Prints the content of a route
 */
-void printRoute(pair<vector<int>, int> route);
+void printRoute(const Solution &solution, int route, const ProblemInstance &instance);
 /*
 * Prints the content of a solution
 */
-void printSolution(vector<pair<vector<int>, int>> solution);
+void printSolution(const Solution &solution, const ProblemInstance &instance);
+/*
+* Returns a solution in which every route is empty (only made of its head)
+*/
+Solution createSolution(const ProblemInstance &instance);
+/*
+* Returns the Manual Action at the given position (from 1) of a route, walking from the closest end of the route
+*/
+int getActionAtPosition(const SolutionData &solution, int route, int position);
+/*
+* Returns the nodes of a route as a vector : the depot node of its Operator, then its Manual Actions in order
+*/
+vector<int> getRoute(const SolutionData &solution, int route, const ProblemInstance &instance);
+/*
+* Renumbers the positions of the nodes of a route from the node first (included) to the end of the route
+*/
+void renumberRoute(SolutionData &solution, int first);
+/*
+* Inserts a Manual Action (which must not be in a route) right after the node previous (a Manual Action or a head)
+*/
+void insertActionAfter(SolutionData &solution, int action, int previous);
+/*
+* Inserts a Manual Action (which must not be in a route) in a route, so that it ends up at the given position
+*		Positions go from 1 to routeLength + 1 (the end of the route)
+*/
+void insertAction(SolutionData &solution, int action, int route, int position);
+/*
+* Removes a Manual Action from its route
+*/
+void removeAction(SolutionData &solution, int action);
+/*
+* Exchanges the places of two Manual Actions, in the same route or not
+*/
+void swapActions(SolutionData &solution, int action1, int action2);
+/*
+* Moves a Manual Action right after the node previous of the same route
+*/
+void relocateAction(SolutionData &solution, int action, int previous);
+/*
+* Reverses the part of a route going from the Manual Action first to the Manual Action last (included)
+*/
+void reverseSegment(SolutionData &solution, int first, int last);
+/*
+* Moves the part of a route from first to last (included) right after the node after of the same route,
+* which must be outside of the part, reversing the part if asked
+*/
+void moveSegment(SolutionData &solution, int first, int last, int after, bool reversed);
+/*
+* Replaces the Manual Actions of a route by the given ones, in order
+*/
+void setRouteActions(SolutionData &solution, int route, const vector<int> &actions);
+/*
+* Returns the travel time from the node from to the node to of a route
+*		A head stands for the depot of its Operator when it is the origin, going back to it costs nothing (end of the route)
+*/
+int getArcCost(const SolutionData &solution, int from, int to, const ProblemInstance &instance);
+/*
+* Move evaluation : the change of the cost of a route if a move was applied, computed from the arcs it changes only
+*		The route is not modified, so that a move can be scored before deciding to apply it
+*/
+/*
+* Cost change of exchanging two Manual Actions of the same route (swapActions)
+*/
+int evaluateSwap(const SolutionData &solution, int action1, int action2, const ProblemInstance &instance);
+/*
+* Cost change of moving a Manual Action right after the node previous of the same route (relocateAction)
+*/
+int evaluateRelocate(const SolutionData &solution, int action, int previous, const ProblemInstance &instance);
+/*
+* Cost change of removing a Manual Action from its route
+*/
+int evaluateRemoval(const SolutionData &solution, int action, const ProblemInstance &instance);
+/*
+* Cost change of inserting a Manual Action (which is not in the route) right after the node previous
+*/
+int evaluateInsertion(const SolutionData &solution, int action, int previous, const ProblemInstance &instance);
+/*
+* Returns the cost change of inserting a Manual Action at its cheapest place in a route, and the node to insert it after
+*		The node removed (-1 for none) of the route is considered as already gone
+*/
+int findCheapestInsertion(const SolutionData &solution, int action, int route, int removed, int &after, const ProblemInstance &instance);
+/*
+* Cost change of moving the part of a route from first to last right after the node after (moveSegment)
+*		The travel times inside the part come from the prefix sums when it is reversed
+*/
+int evaluateSegmentMove(const SolutionData &solution, int first, int last, int after, bool reversed, const ProblemInstance &instance);
+/*
+* Cost change of reversing the part of a route from first to last (reverseSegment)
+*		The travel times inside the part come from the prefix sums, which must be up to date
+*/
+int evaluateReversal(const SolutionData &solution, int first, int last, const ProblemInstance &instance);
+/*
+* Recomputes the cost of a route and its prefix sums
+*/
+void updateRouteCost(SolutionData &solution, int route, const ProblemInstance &instance);
+/*
+* Changes the cost of a route, then updates the tournament tree and the makespan
+*/
+void setRouteCost(SolutionData &solution, int route, int cost);
+/*
+* Rebuilds the tournament tree of the route costs and the makespan
+*/
+void buildCostTree(SolutionData &solution);
+/*
+* Returns the route with the highest cost among two nodes of the tournament tree (-1 for none)
+*		On a tie the route with the lowest index wins
+*/
+int getCostWinner(const SolutionData &solution, int route1, int route2);
+/*
+* Reads the makespan, the route that creates it and the second highest cost from the tournament tree
+*/
+void refreshMakespan(SolutionData &solution);
+/*
+* Returns the highest cost among the routes other than route1 and route2 (0 if there is none)
+*		Only the subtrees holding one of the two routes are opened, which takes O(log M)
+*/
+int getMakespanWithout(const SolutionData &solution, int route1, int route2);
+/*
+* Returns the highest cost among the routes other than route1 and route2 in the subtree of a node of the tournament tree
+*/
+int getSubtreeMakespanWithout(const SolutionData &solution, int node, int route1, int route2);
 /*
 * Builds the service time matrix
 */
 vector<int> buildServiceTime(XMLNode *MARoot);
 /*
-* Builds the eligibility matrix :
-*		eligibility[i][j] = 1 if Operator j has the required skill for the Manual Operation i
-*		eligibility[i][j] = 0 otherwise
+* Builds the eligibility bitsets :
+*		the SystemCodes of the Operators are interned once, giving the mask of the Operators owning each SystemCode,
+*		the mask of a Manual Action is then the one of its SystemCode
+*/
+Eligibility buildEligibility(XMLNode *MARoot, XMLNode *OPRoot);
+/*
+* Returns the number of bits set in a word
+*/
+int popcount64(uint64_t word);
+/*
+* Returns the number of bits set in a bitset of words
+*/
+int countBits(const uint64_t *bits, int words);
+/*
+* Returns the position of the n-th (starting from 0) bit set in a bitset of words, -1 if there are not enough bits set
+*/
+int selectBit(const uint64_t *bits, int words, int n);
+/*
+* Returns the key identifying a room : its SrtpCode and its Deck
+*/
+string roomKey(const XMLElement *Room);
+/*
+* Returns the id of a room (SrtpCode + Deck), interning it if it is not known yet
+*/
+int internRoom(MinPathIndex &index, const string &SrtpCode, const string &Deck);
+/*
+* Returns the id of a room (SrtpCode + Deck), or -1 if the room is unknown
+*/
+int findRoom(const MinPathIndex &index, XMLElement *Room);
+/*
+* Returns the key of the unordered pair of rooms (room1, room2)
+*/
+unsigned long long roomPairKey(int room1, int room2);
+/*
+* Opens a file for the streaming XML reader
+*/
+bool openXMLPullParser(XMLPullParser &parser, string fileName);
+/*
+* Returns the next character of the file without consuming it (EOF at the end of the file)
+*/
+int peekXMLChar(XMLPullParser &parser);
+/*
+* Returns and consumes the next character of the file (EOF at the end of the file)
+*/
+int nextXMLChar(XMLPullParser &parser);
+/*
+* Consumes the file until (and including) the given terminator
+*/
+void skipXMLUntil(XMLPullParser &parser, const char *terminator);
+/*
+* Replaces the predefined entities of a text (&amp; &lt; &gt; &quot; &apos; and numeric ones, encoded in UTF-8)
+*/
+string decodeXMLText(const string &text);
+/*
+* Reads the next token of the file :
+*		XML_PULL_START / XML_PULL_END with the name of the element in value (<Tag/> gives both)
+*		XML_PULL_TEXT with the text (trimmed and decoded) in value
+*		XML_PULL_EOF at the end of the file
+*		Declarations, comments and attributes are skipped
+*/
+XMLPullToken nextXMLToken(XMLPullParser &parser, string &value);
+/*
+* Streams the minimum paths file once to build its index, without building the XML tree :
+*		the travel time of every pair of rooms and the extended path (the GraphArc of RoomsBetween) of every ordered pair
+*		Only the pairs whose both rooms are in roomsOfInterest (keys given by roomKey) are kept, every pair if it is empty
+*/
+bool loadMinPathIndex(string fileName, const unordered_set<string> &roomsOfInterest, MinPathIndex &index);
+/*
+* Gives the minimum time to go from room1 to room2 (ids of the index), or -1 if the pair is missing
+*/
+int getMinPathBetweenRoomIds(const MinPathIndex &index, int room1, int room2);
+/*
+* Interns the room (SrtpCode + Deck) of every Manual Action, then of every starting room, into a dense room id :
+*		minPath.MARoom[i] is the room id of the i-th Manual Action for i < numberOfMA,
+*		the room id of the starting room Starts[i - numberOfMA] (its depot node) otherwise
+*		rooms[r] is the Room element of the first Manual Action (or starting room) located in room r
+*/
+void buildMARooms(XMLNode *MARoot, const vector<XMLElement*> &Starts, MinPathMatrix &minPath, vector<XMLElement*> &rooms);
+/*
+* Sets the layout of the room matrix of minPath (full or packed triangle) for the given number of rooms
+*/
+void setMinimumPathLayout(MinPathMatrix &minPath, int rooms, bool packed);
+/*
+* Allocates the (zero filled, 64 bytes aligned) room matrix of minPath and returns it for writing
+*		The matrix is packed if MIN_PATH_PACKED is set
+*/
+uint16_t* allocateMinimumPath(MinPathMatrix &minPath, int rooms);
+/*
+* Converts a minimum path to its stored value, saturating (and counting in overflows) the ones above MIN_PATH_MAX
+*/
+uint16_t compactMinimumPath(int length, atomic<int> &overflows);
+/*
+* Returns the id of a room of the graph, interning it if it is not known yet
+*/
+int internGraphRoom(RoomGraph &graph, const XMLElement *Room);
+/*
+* Returns the id of a room of the graph, or -1 if the room is not in the graph
+*/
+int findGraphRoom(const RoomGraph &graph, const XMLElement *Room);
+/*
+* Reads the minimum paths between the rooms from fileName : into graph if useRoomGraph is set (plain graph of the rooms),
+*		into index otherwise (minimum paths file, only the pairs between the rooms of interest are kept)
+*/
+bool loadMinPathSource(string fileName, bool useRoomGraph, const unordered_set<string> &roomsOfInterest, RoomGraph &graph, MinPathIndex &index);
+/*
+* Builds the graph of the rooms from every GraphArc element found under root
+*		This works both on a plain deck graph file and on the RoomsBetween of a minimum paths file
+*/
+RoomGraph buildRoomGraph(XMLNode *root);
+/*
+* Dijkstra from the room source : fills distance (INT_MAX if unreachable) and predecessor (one entry per room)
+*/
+void computeRoomDistances(const RoomGraph &graph, int source, vector<int> &distance, int32_t *predecessor);
+/*
+* Runs Dijkstra from every source room, the sources being shared between numberOfThreads workers
+*/
+RoomShortestPaths computeRoomShortestPaths(const RoomGraph &graph, const vector<int> &sourceRooms, int numberOfThreads);
+/*
+* Gives the travel time of the arc between two adjacent rooms
+*/
+int getArcTime(const RoomGraph &graph, int room1, int room2);
+/*
+* Returns the arcs (room1, room2, travel time) of the shortest path between two rooms of the graph
+*		The predecessors of paths are used if fromRoom is one of its sources, otherwise Dijkstra is run from fromRoom
+*/
+vector<tuple<int, int, int>> getRoomGraphPath(const RoomGraph &graph, const RoomShortestPaths &paths, int fromRoom, int toRoom);
+/*
+* Builds the matrix of minimum paths between the rooms of the Manual Actions and of the starting rooms using the room graph
+*		paths receives the shortest paths from every room of a Manual Action or a starting room
+*/
+MinPathMatrix computeMinimumPathFromGraph(XMLNode *MARoot, const vector<XMLElement*> &Starts, const RoomGraph &graph, RoomShortestPaths &paths, string fileName, uint64_t inputHash, int numberOfThreads);
+/*
+* Prints the progress bar of the computation of the minimum path matrix, with a slot every 5%
+*/
+void printProgress(int completion);
+/*
+* Builds the matrix of minimum paths between the rooms that require a Manual Action to be done and the starting rooms
+* The matrix is computed between rooms, the Manual Actions that share a room share the same row and column
+* The rows are shared between numberOfThreads workers (0 means one per hardware thread),
+* every worker fills its rows of the preallocated matrix, which is saved once in the binary cache fileName
+*/
+MinPathMatrix computeMinimumPath(XMLNode *MARoot, const vector<XMLElement*> &Starts, const MinPathIndex &index, string fileName, uint64_t inputHash, int numberOfThreads);
+/*
+* Maps a whole file in memory, returns nullptr if the file cannot be mapped
+*/
+shared_ptr<MappedFile> mapFile(string fileName);
+/*
+* FNV-1a hash of a buffer, hash is the value to continue from
+*/
+uint64_t hashBytes(const void *data, size_t size, uint64_t hash = 14695981039346656037ULL);
+/*
+* Hash of the inputs that determine the minimum path matrix :
+*		the room (SrtpCode + Deck) of every Manual Action and of every starting room, in order,
+*		and the size and last write time of the minimum paths file (left out if minPathFileName is empty or missing)
+*/
+uint64_t hashMinPathInputs(XMLNode *MARoot, const vector<XMLElement*> &Starts, string minPathFileName);
+/*
+* Writes the binary cache of the minimum path matrix
+*		standalone is set if the matrix does not come from any minimum paths file
 */
-vector<vector<int>> buildEligibility(XMLNode *MARoot, XMLNode *OPRoot);
+bool saveMinPathCache(string fileName, const MinPathMatrix &minPath, uint64_t inputHash, bool standalone);
 /*
-* Gives the minimum time to go from Room1 to Room2
+* Maps the binary cache of the minimum path matrix and uses it in place
+*		minPath.MARoom must already be built, the cache is rejected if it is not consistent with it
+*		header receives the header of the cache
 */
-int getMinPathBetweenRooms(XMLNode *MPRoot, XMLElement *MARoom1, XMLElement *MARoom2);
+bool loadMinPathCache(string fileName, MinPathMatrix &minPath, MinPathCacheHeader &header);
 /*
-* Builds the matrix of minimum paths between the rooms that require a Manual Action to be done
-* Also, the last element of each row is the time needed between the manual action and the starting room of the operators
+* Converts a minPathMatrix_X.csv file into the binary cache
+*		The rows of the starting rooms missing from the csv file are completed from the index, if it is given (not NULL)
+*		Nothing is written if the csv file is missing or incomplete
 */
-vector<vector<int>> computeMinimumPath(XMLNode *MARoot, XMLNode *MPRoot, string fileName, int MA_file_id);
+bool convertMinPathCsv(XMLNode *MARoot, const vector<XMLElement*> &Starts, string csvFileName, string fileName, uint64_t inputHash, const MinPathIndex *index);
 /*
- * Loads the data in .csv files about the minPath matrix
+ * Loads the data in .csv files about the minPath matrix into minPath
+ * Only the row of the first Manual Action of every room is kept
+ * The file may go on with the rows of the starting rooms (after the Manual Actions, in the order of Starts)
+ * The rooms without any row in the file (eg. the starting rooms) are completed from the index if it is given
+ *		Returns false if the file is missing, if a row has less than one column per Manual Action,
+ *		or if a room has no row and there is no index to complete it
  */
-vector<vector<int>> loadMinimumPath(string fileName);
+bool loadMinimumPath(XMLNode *MARoot, const vector<XMLElement*> &Starts, string fileName, const MinPathIndex *index, MinPathMatrix &minPath);
+/*
+* Loads every starting room file (prefix0.xml, prefix1.xml, ... until one is missing), the documents are kept in startFiles
+*/
+vector<XMLElement*> loadStartRooms(string prefix, vector<unique_ptr<XMLDocument>> &startFiles);
+/*
+* Returns the depot node of every Operator : the starting room given by its optional <Start> element (id of the
+* start_X.xml file), defaultStart otherwise
+*/
+vector<int> buildOperatorStart(XMLNode *OPRoot, const MinPathMatrix &minPath, int defaultStart);
+/*
+* Builds the nearest Manual Actions of every Manual Action (k of them, plus the ties), overall and for every Operator
+*/
+NeighborLists buildNeighborLists(const MinPathMatrix &minPath, const Eligibility &eligibility, int k);
 /*
-* Returns the vector with the minimum time between the starting room and every Manual Action
+* Builds the data of the problem from the Manual Actions, the Operators and the (already built) minimum path matrix
+*		defaultStart is the id of the starting room of the Operators without a <Start> element
 */
-vector<int> computeStartRoomMinimumPath(XMLNode *MARoot, XMLNode *MPRoot, XMLElement *Start);
+ProblemInstance buildProblemInstance(XMLNode *MARoot, XMLNode *OPRoot, const MinPathMatrix &minPath, int defaultStart);
+/*
+* Returns the keys of the rooms of the Manual Actions and of the starting rooms
+*/
+unordered_set<string> buildRoomsOfInterest(XMLNode *MARoot, const vector<XMLElement*> &Starts);
 /*
 * Builds an initial (possibly) good and feasible solution to the problem
 *		General Algorithm :
 *			- Loop over k from 1 to NumberOfOperators
-*				- Loop over the eligibility matrix
-*					- If the number of possible Operators that are skilled for the ongoing Manual Action is equal to k
-*						- Assign an operator to fulfill the Manual Action
+*				- Loop over the Manual Actions whose number of skilled Operators (popcount of their eligibility mask) is equal to k
+*					- Assign an operator to fulfill the Manual Action
 *
 *		The idea of the k loop is to assign Manual Actions that are feasible by a few number of Operator first
 *			(e.g. if a Manual Action can be done only by one Operator, it has to be assigned to him anyway)
+*		Every route starts with the depot node of its Operator (operatorStart)
 *		The assignment of an Operator to a Manual Action is randomly chosen between the eligible Operators for this
 *			Manual Action, taking into account the already assigned Manual Actions
 *			-> we would prefer to assign a Manual Action to an Operator who hasn't be assigned yet any Manual Action or whose route is "small"
 */
-vector<pair<vector<int>, int>> generateInitialSolution(vector<vector<int>> eligibility, vector<vector<int>> minPath, vector <int> startRoomMinPath, vector<int> serviceTime);
+Solution generateInitialSolution(const ProblemInstance &instance, RandomStream &random);
 /*
-* Calculates the total cost of a route
+* Calculates the total cost of a route, starting from the depot node of its Operator
 */
-int calculateLengthOfRoute(vector<int> route, vector<vector<int>> minPath, vector<int> startRoomMinPath, vector<int> serviceTime);
+int calculateLengthOfRoute(const SolutionData &solution, int route, const ProblemInstance &instance);
 /*
 * INTRA-ROUTE heuristic
-* This heuristic looks for improvements inside the route of every operator
-* The idea is to swap two consecutive Manual Action inside the route of an operator and see if this improves its path
-* Then we increment the number of consecutive Manual Actions and we do this process again
+* This heuristic drives the route of an operator to a local optimum of the 2-opt, Or-opt and swap moves
+* Every node of the route is only combined with its INTRA_NEIGHBORS nearest Manual Actions of the route,
+* and is not looked at again (don't-look bit) until a move changes one of its arcs
 */
-pair<vector<int>, int> intraRouteHeuristic(pair<vector<int>, int> route, vector<vector<int>> minPath, vector<int> startRoomMinPath, vector<int> serviceTime);
+void intraRouteHeuristic(SolutionData &solution, int route, const ProblemInstance &instance);
+/*
+* Improves the route of an operator : exactly (sequenceRouteExactly) if it visits at most HELD_KARP_MAX_LENGTH distinct rooms,
+* with the intra-route heuristic otherwise
+*/
+void optimizeRoute(SolutionData &solution, int route, const ProblemInstance &instance, SequencingBuffers &buffers);
+/*
+* Exact sequencing of a route (Held-Karp dynamic programming over the subsets of its rooms)
+*		The Manual Actions located in the same room are visited one after the other, so only the distinct rooms are sequenced
+*		The time and the memory grow as 2^rooms, HELD_KARP_MAX_LENGTH is meant to stay between 12 and 16
+*		Returns false, leaving the route unchanged, if it visits more than HELD_KARP_MAX_LENGTH distinct rooms
+*		The table and the other work arrays are kept in buffers, so that sequencing a route allocates nothing once they have grown
+*/
+bool sequenceRouteExactly(SolutionData &solution, int route, const ProblemInstance &instance, SequencingBuffers &buffers);
+/*
+* Looks for the first improving move of the intra-route heuristic around the node of a route, and applies it
+*		neighbors holds the nearest Manual Actions of every node (count per node, indexed by localIndex)
+*		touched receives the nodes whose arcs changed
+*/
+bool improveAroundNode(SolutionData &solution, int node, const vector<int> &neighbors, int count, const vector<int> &localIndex, vector<int> &touched, const ProblemInstance &instance);
 /*
 * Returns the index of the operator that creates the Cmax
 */
-int getMaxCostRoute(vector<pair<vector<int>, int>> solution);
+int getMaxCostRoute(const Solution &solution);
 /*
 * TRANSFER heuristic
 * The goal of this heuristic is to select a specific MA and re-affect it to an other eligible OP
-* Each route are then improved using the intra-route heuristic
+* Each route are then improved using the intra-route heuristic (once the move is applied)
 * As we want to reduce the maximum cost, we first apply this heuristic to the route which has the highest cost
+* The Manual Action goes to its best insertion among every position of every eligible route
+* The move has no Manual Action (action1 is -1) if the drawn one has no other eligible Operator
 */
-transferSolutionTuple transferHeuristic(vector<pair<vector<int>, int>> solution, vector<vector<int>> eligibility, vector<vector<int>> minPath, vector<int> startRoomMinPath, vector<int> serviceTime);
+Move transferHeuristic(const SolutionData &solution, const ProblemInstance &instance, SearchWorker &worker);
+/*
+* Best insertion : returns the k best transfers (sorted with compareMove) of a Manual Action, scanning every position
+* of every eligible route other than its own one
+*/
+void findBestTransfers(const SolutionData &solution, int action, int k, const ProblemInstance &instance, vector<Move> &bestMoves);
+/*
+* Granular transfer : returns the k best transfers (sorted with compareMove) of a Manual Action right before or right after
+* one of its nearest Manual Actions, in an other route able to receive it
+*/
+void findGranularTransfers(const SolutionData &solution, int action, int k, const ProblemInstance &instance, vector<Move> &bestMoves);
+/*
+* Adds a move to the k best moves (sorted with compareMove) if it is one of them
+*/
+void keepBestMoves(vector<Move> &bestMoves, const Move &move, int k);
+/*
+* Returns a random Manual Action of the route that creates the Cmax
+*/
+int drawCriticalAction(const SolutionData &solution, RandomStream &random);
 /*
 * SWAP heuristic
 * The objective of this heuristic is to swap two Manual Actions of two different routes
 * The first Manual Action is one taken from the route that creates the Cmax
-* The other one is chosen randomly between the Manual Action feasible by the OP and not already in his route
+* The other one is chosen randomly between the Manual Action feasible by the OP and not already in his route,
+* among the routes of the Operators who can perform the first one (action2 is -1 if there is none)
+*/
+Move swapHeuristic(const SolutionData &solution, const ProblemInstance &instance, SearchWorker &worker);
+/*
+* Granular swap : returns the swap of a Manual Action with a random one of its nearest Manual Actions that its Operator can perform,
+* taken from an other route able to receive it (action2 is -1 if there is none)
+*/
+Move findGranularSwap(const SolutionData &solution, int action, const ProblemInstance &instance, SearchWorker &worker);
+/*
+* Scores a swap move whose actions and routes are set : positions, insertion places, cost changes and makespan
+*/
+void scoreSwap(const SolutionData &solution, Move &move, const ProblemInstance &instance);
+/*
+* Applies a move returned by a heuristic, then improves the two routes it changed (optimizeRoute)
+*/
+void applyMove(SolutionData &solution, const Move &move, const ProblemInstance &instance, SequencingBuffers &buffers);
+/*
+* Returns an empty tabu memory for the instance
+*		The tenure is TABU_TENURE, or the mean number of Manual Actions per Operator (at least 8) if TABU_TENURE is 0
+*/
+TabuMemory createTabuMemory(const ProblemInstance &instance);
+/*
+* Returns true if a move takes one of its Manual Actions out of a route it was recently taken out of
 */
-swapSolutionTuple swapHeuristic(vector<pair<vector<int>, int>> solution, vector<vector<int>> eligibility, vector<vector<int>> minPath, vector<int> startRoomMinPath, vector<int> serviceTime);
+bool isTabuMove(const TabuMemory &memory, const Move &move);
+/*
+* Makes tabu the attributes (Manual Action, route it leaves) of an accepted move, then goes to the next iteration
+*/
+void recordTabuMove(TabuMemory &memory, const Move &move);
+/*
+* Makes one draw of the candidate pool of the tabu search into moves :
+*		TRANSFER_MOVE : the TRANSFER_TOP_K best insertions of a random Manual Action of the max cost route,
+*		next to its nearest Manual Actions if GRANULAR_SEARCH is set (everywhere if there is no such insertion)
+*		SWAP_MOVE : a swap of a random Manual Action of the max cost route, with one of its nearest Manual Actions
+*		if GRANULAR_SEARCH is set (with any eligible one if there is none)
+*/
+void drawCandidates(const SolutionData &solution, MoveType type, const ProblemInstance &instance, SearchWorker &worker, vector<Move> &moves);
+/*
+* Returns the index of the best admissible move of a pool (-1 if there is none) :
+* the first one for compareMove that is not tabu, or that leads to a makespan lower than bestMakespan (aspiration)
+*/
+int findBestAdmissibleMove(const vector<Move> &moves, const TabuMemory &memory, int bestMakespan);
+/*
+* Starts the threads of a pool of numberOfWorkers workers (the calling thread is the worker 0)
+*/
+void startWorkerPool(WorkerPool &pool, int numberOfWorkers);
+/*
+* Runs job(worker) on every worker of a pool, and returns once they are all done
+*/
+void runOnWorkers(WorkerPool &pool, const function<void(int)> &job);
+/*
+* Loop of the thread of a worker of a pool : waits for a job, runs it, then signals it is done
+*/
+void runWorker(WorkerPool &pool, int worker);
 /*
 * Calls the different heuristics to improve the initial solution
+*		The candidate pools of the tabu search are drawn by numberOfWorkers workers, seeded from random
+*		The search stops once maxTimeAllowed seconds have passed since t1, or after ITERATION_BUDGET iterations if it is set
+*		If island is not NULL, the search migrates every MIGRATION_INTERVAL iterations or MIGRATION_PERIOD_MS milliseconds
+*/
+Solution tabuSearch(Solution solution, const ProblemInstance &instance, RandomStream &random, int numberOfWorkers, chrono::steady_clock::time_point t1, int maxTimeAllowed, Island *island);
+Solution customSearch(Solution solution, const ProblemInstance &instance, RandomStream &random, chrono::steady_clock::time_point t1, int maxTimeAllowed);
+Solution simulatedAnnealing(Solution solution, const ProblemInstance &instance, RandomStream &random, chrono::steady_clock::time_point t1, int maxTimeAllowed);
+/*
+* Returns true if every Manual Action is in exactly one route, of an Operator who can perform it
+*/
+bool isSolutionFeasible(const SolutionData &solution, const ProblemInstance &instance);
+/*
+* Returns true once a search has spent its budget : ITERATION_BUDGET iterations if it is set, maxTimeAllowed seconds since t1 otherwise
+*		Only the iteration budget makes a run depend on nothing else than its seed
+*/
+bool isBudgetSpent(int iterations, chrono::steady_clock::time_point t1, int maxTimeAllowed);
+/*
+* Returns the wall time (seconds) passed since t1
+*		The runs are timed on the wall clock, as clock() sums the CPU time of every thread on some platforms
+*/
+float elapsedSeconds(chrono::steady_clock::time_point t1);
+/*
+* Returns true if the island has to migrate : after MIGRATION_INTERVAL iterations or MIGRATION_PERIOD_MS milliseconds (0 disables either)
+*		The period is not used when ITERATION_BUDGET is set, so that the islands migrate at the same iterations
+*/
+bool isMigrationDue(const Island &island);
+/*
+* Waits until every island of the barrier has reached it
+*/
+void waitForIslands(MigrationBarrier &barrier);
+/*
+* Writes a solution into a mailbox
+*/
+void publishSolution(Mailbox &mailbox, const SolutionData &solution);
+/*
+* Copies the solution of a mailbox into next if it has been published since the given version, and updates version
+*		Returns false if there is no such solution or if it is being written, without waiting
+*/
+bool receiveSolution(const Mailbox &mailbox, unsigned int &version, int &makespan, vector<int> &next);
+/*
+* Builds the solution whose nodes have the given successors
+*/
+Solution buildSolutionFromSuccessors(const vector<int> &next, const ProblemInstance &instance);
+/*
+* Migration of an island : publishes bestSolution if it has improved since the last migration, then takes the immigrant
+* of the islands given by MIGRATION_TOPOLOGY, which replaces solution as decided by MIGRATION_REPLACEMENT
+*		In a deterministic run, the islands publish, then read, then go on together
+*		Returns true if solution has been replaced
+*/
+bool migrate(Island &island, const Solution &bestSolution, Solution &solution, const ProblemInstance &instance);
+/*
+* Runs one start of the multi-start search : an initial solution improved by the tabu search, with the random stream seeded by result.seed
+*		island is the place of the start in the island model (NULL if it is run alone)
+*/
+void runStart(const ProblemInstance &instance, int maxTimeAllowed, int numberOfWorkers, Island *island, StartResult &result);
+/*
+* Runs one start per seed, numberOfThreads of them at the same time (0 means all of them), every start reading the same instance
+*		Every start draws its candidate pools with SEARCH_THREADS workers (0 shares the hardware threads between the concurrent starts,
+*		or means one worker if ITERATION_BUDGET is set, so that the draws do not depend on the hardware)
+*		If ISLAND_MODEL is set, every start is an island which exchanges its best solutions with the others,
+*		and all the starts run at the same time whatever numberOfThreads
+*		The results are given in the order of the seeds
 */
-vector<pair<vector<int>, int>> tabuSearch(vector<pair<vector<int>, int>> solution, vector<vector<int>> minPath, vector<int> startRoomMinPath, vector<int> serviceTime, vector<vector<int>> eligibility, clock_t t1, int maxTimeAllowed);
-vector<pair<vector<int>, int>> customSearch(vector<pair<vector<int>, int>> solution, vector<vector<int>> minPath, vector<int> startRoomMinPath, vector<int> serviceTime, vector<vector<int>> eligibility, clock_t t1, int maxTimeAllowed);
-vector<pair<vector<int>, int>> simulatedAnnealing(vector<pair<vector<int>, int>> solution, vector<vector<int>> minPath, vector<int> startRoomMinPath, vector<int> serviceTime, vector<vector<int>> eligibility, clock_t t1, int maxTimeAllowed);
+vector<StartResult> runStarts(const ProblemInstance &instance, const vector<uint64_t> &seeds, int maxTimeAllowed, int numberOfThreads);
 /*
  * Returns the i-th Manual Action
  */
 XMLNode* getMAUsingMAIndex(int MAindex, XMLNode *MARoot);
 /*
-* Returns the extended paths between two rooms (eg. all the rooms inbetween)
+* Returns the extended paths between two rooms (eg. all the rooms inbetween) : (room1, room2, travel time) of every arc
+*		If only the opposite direction is known, its arcs are returned in the reverse order
 */
-vector<tuple<XMLElement*, XMLElement*, int>> getExtendedRouteBetweenRooms(XMLElement* Room1, XMLElement* Room2, XMLNode* MPRoot);
+vector<tuple<int, int, int>> getExtendedRouteBetweenRooms(const MinPathIndex &index, int room1, int room2);
 /*
 * Writes in a file the info of the paths taken by the operators
+*		The paths between rooms come from the room graph if it is given, from the index of the minimum paths file otherwise,
+*		they are left out if neither is given
+*		rooms are the Room elements of the room ids of minPath
 */
-void postProcessing(string fileName, vector<pair<vector<int>, int>> solution, XMLNode *MPRoot, XMLNode *MARoot, XMLElement *Start, vector<vector<int>> minPath, vector<int> startRoomMinPath);
\ No newline at end of file
+void postProcessing(string fileName, const Solution &solution, XMLNode *MARoot, const vector<XMLElement*> &rooms, const ProblemInstance &instance, const MinPathIndex *index, const RoomGraph *graph, const RoomShortestPaths *paths);
\ No newline at end of file